@@ -0,0 +1,101 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace tema {
+struct ManifestEntry {
+    std::uint64_t source_hash;
+    std::string   options;
+    std::string   version;
+};
+
+// Record of what each output was rendered from, keyed by the source path
+// relative to the source directory
+class Manifest {
+    private:
+    std::unordered_map<std::string, ManifestEntry> mEntries;
+
+    public:
+    bool load(const std::filesystem::path &path);
+    bool save(const std::filesystem::path &path) const;
+
+    std::optional<ManifestEntry> find(const std::string &source) const;
+    void set(const std::string &source, ManifestEntry entry);
+
+    inline const std::unordered_map<std::string, ManifestEntry> &
+    entries() const {
+        return this->mEntries;
+    }
+};
+
+struct BuildStats {
+    std::size_t rendered = 0;
+    std::size_t fresh    = 0;
+    std::size_t removed  = 0;
+    std::size_t failed   = 0;
+};
+
+class Builder {
+    private:
+    const std::filesystem::path mSourceDir;
+    const std::filesystem::path mOutputDir;
+    const std::string           mExtension;
+    const std::size_t           mMaxLineWidth;
+    const std::size_t           mBorderWidth;
+    const std::size_t           mIndentWidth;
+
+    public:
+    Builder(std::filesystem::path source_dir,
+            std::filesystem::path output_dir,
+            std::string           extension,
+            std::size_t           max_line_width,
+            std::size_t           border_width,
+            std::size_t           indent_width)
+        : mSourceDir(source_dir), mOutputDir(output_dir),
+          mExtension(extension), mMaxLineWidth(max_line_width),
+          mBorderWidth(border_width), mIndentWidth(indent_width) {};
+
+    BuildStats build();
+
+    inline const std::filesystem::path &source_dir() const {
+        return this->mSourceDir;
+    }
+
+    inline const std::filesystem::path &output_dir() const {
+        return this->mOutputDir;
+    }
+
+    // Only files with this extension are rendered
+    inline const std::string &extension() const {
+        return this->mExtension;
+    }
+
+    private:
+    std::string           options() const;
+    bool                  is_source(const std::filesystem::path &path) const;
+    std::filesystem::path output_path(const std::string &source) const;
+    std::filesystem::path manifest_path() const;
+    bool                  render(const std::string &source,
+                                 const std::string &content) const;
+};
+} // namespace tema
@@ -17,6 +17,7 @@
 
 #include <cwchar>
 #include <louvre/api.hpp>
+#include <optional>
 #include <string>
 #include <tema/format.hpp>
 #include <tema/util.hpp>
@@ -26,7 +27,8 @@ class EmitterSettings : public Singleton<EmitterSettings> {
     friend class Singleton<EmitterSettings>;
 
     private:
-    std::string mEol = "\r\n";
+    std::string mEol       = "\r\n";
+    bool        mHyphenate = true;
 
     public:
     inline void set_eol(std::string eol) {
@@ -36,6 +38,23 @@ class EmitterSettings : public Singleton<EmitterSettings> {
     inline const std::string eol() const {
         return this->mEol;
     }
+
+    // Whether words longer than a line are broken
+    inline void set_hyphenate(bool hyphenate) {
+        this->mHyphenate = hyphenate;
+    }
+
+    inline bool hyphenate() const {
+        return this->mHyphenate;
+    }
+};
+
+// How a container node lays out its children
+struct Layout {
+    std::size_t indent              = 0;
+    std::size_t indent_ignore_lines = 0;
+    std::string prefix;
+    Formatter  *children_formatter = nullptr;
 };
 
 class Emitter {
@@ -56,6 +75,11 @@ class Emitter {
                                std::size_t                   avail_width,
                                Formatter                    &formatter);
 
+    // Lazily renders root one line at a time, without EOL. Joining the lines
+    // with the EOL yields the same text as emit. The emitter must outlive the
+    // returned generator
+    Generator<std::string> lines(std::shared_ptr<louvre::Node> root);
+
     inline std::size_t max_line_width() const {
         return this->mMaxLineWidth;
     }
@@ -69,6 +93,18 @@ class Emitter {
     }
 
     private:
+    // Leaves (line breaks and text) have no layout
+    std::optional<Layout> layout(std::shared_ptr<louvre::Node> root,
+                                 Formatter                    &formatter);
+
+    Generator<std::string> emit_leaf(std::shared_ptr<louvre::Node> root,
+                                     std::size_t                   avail_width,
+                                     Formatter                    &formatter);
+
+    Generator<std::string> emit_lazy(std::shared_ptr<louvre::Node> root,
+                                     std::size_t                   avail_width,
+                                     Formatter                    &formatter);
+
     inline bool
     can_ignore_prev_line_break(std::shared_ptr<louvre::Node> prev_child) const;
 };
@@ -22,6 +22,7 @@
 #include <tema/split.hpp>
 #include <tema/util.hpp>
 #include <utility>
+#include <vector>
 
 namespace tema {
 class Indenter {
@@ -30,6 +31,13 @@ class Indenter {
                                std::size_t       indent_width,
                                std::size_t       ignore_before_line = 0) = 0;
 
+    // Same as indent, but consumes and produces text in fragments. The
+    // default implementation collects the whole text first
+    virtual Generator<std::string>
+    indent_lazy(Generator<std::string> text,
+                std::size_t            indent_width,
+                std::size_t            ignore_before_line = 0);
+
     protected:
     std::pair<std::string, std::size_t>
     ignored_before_line(std::stringstream &text_stream,
@@ -45,6 +53,11 @@ class NullIndenter : public Singleton<NullIndenter>, public Indenter {
                        std::size_t       ignore_before_line = 0) override {
         return text;
     }
+
+    Generator<std::string>
+    indent_lazy(Generator<std::string> text,
+                std::size_t            indent_width,
+                std::size_t            ignore_before_line = 0) override;
 };
 
 class LeftIndenter : public Singleton<LeftIndenter>, public Indenter {
@@ -54,6 +67,11 @@ class LeftIndenter : public Singleton<LeftIndenter>, public Indenter {
     std::string indent(const std::string text,
                        std::size_t       indent_width,
                        std::size_t       ignore_before_line = 0) override;
+
+    Generator<std::string>
+    indent_lazy(Generator<std::string> text,
+                std::size_t            indent_width,
+                std::size_t            ignore_before_line = 0) override;
 };
 
 class RightIndenter : public Singleton<RightIndenter>, public Indenter {
@@ -76,11 +94,27 @@ class Formatter {
     virtual std::string format(const std::string text,
                                std::size_t       max_line_width) = 0;
 
+    // Same as format, but produces the text in fragments as lines are laid
+    // out. The default implementation formats the whole text first
+    virtual Generator<std::string> format_lazy(const std::string text,
+                                               std::size_t max_line_width);
+
     std::string indent(const std::string text,
                        std::size_t       indent_width,
                        std::size_t       ignore_before_line = 0) {
         return this->mIndenter.indent(text, indent_width, ignore_before_line);
     }
+
+    Generator<std::string> indent_lazy(Generator<std::string> text,
+                                       std::size_t            indent_width,
+                                       std::size_t ignore_before_line = 0) {
+        return this->mIndenter.indent_lazy(
+            std::move(text), indent_width, ignore_before_line);
+    }
+
+    protected:
+    std::vector<std::string> break_word(const std::string &word,
+                                        std::size_t        max_line_width) const;
 };
 
 class LeftFormatter : public Singleton<LeftFormatter>, public Formatter {
@@ -90,6 +124,9 @@ class LeftFormatter : public Singleton<LeftFormatter>, public Formatter {
 
     std::string format(const std::string text,
                        std::size_t       max_line_width) override;
+
+    Generator<std::string> format_lazy(const std::string text,
+                                       std::size_t max_line_width) override;
 };
 
 class CenterFormatter : public Singleton<CenterFormatter>, public Formatter {
@@ -97,6 +134,9 @@ class CenterFormatter : public Singleton<CenterFormatter>, public Formatter {
 
     std::string format(const std::string text,
                        std::size_t       max_line_width) override;
+
+    Generator<std::string> format_lazy(const std::string text,
+                                       std::size_t max_line_width) override;
 };
 
 class RightFormatter : public Singleton<RightFormatter>, public Formatter {
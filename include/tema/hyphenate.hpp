@@ -0,0 +1,85 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <tema/util.hpp>
+#include <utility>
+#include <vector>
+
+namespace tema {
+// Liang-style hyphenation patterns packed into a double-array trie. Each
+// cell holds the base of its children, the index of its parent and the
+// offset of its pattern values, so a transition touches a single cell
+class PatternTrie {
+    private:
+    struct Cell {
+        std::int32_t base  = 0;
+        std::int32_t check = -1;
+        std::int32_t value = -1;
+    };
+
+    std::array<std::uint8_t, 256> mCodes{};
+    std::vector<Cell>             mCells;
+    std::vector<std::uint8_t>     mValues;
+
+    public:
+    void build(const std::vector<std::pair<std::string,
+                                           std::vector<std::uint8_t>>> &patterns);
+
+    // Raises points[start + k] to the values of every pattern that matches
+    // text at start
+    void apply(const std::string         &text,
+               std::size_t                start,
+               std::vector<std::uint8_t> &points) const;
+
+    inline bool empty() const {
+        return this->mCells.size() <= 1;
+    }
+};
+
+class Hyphenator : public Singleton<Hyphenator> {
+    friend class Singleton<Hyphenator>;
+
+    private:
+    static constexpr std::size_t LEFT_MIN  = 2;
+    static constexpr std::size_t RIGHT_MIN = 3;
+
+    PatternTrie   mTrie;
+    std::uint64_t mPatternsHash = 0;
+
+    public:
+    bool load(const std::string &path);
+    void load(std::istream &stream);
+
+    // Positions in word before which a hyphen may be inserted
+    std::vector<std::size_t> hyphenation_points(const std::string &word) const;
+
+    // Splits word into pieces no longer than max_line_width, preferring
+    // hyphenation points (which add a hyphen) and falling back to plain
+    // hard breaks
+    std::vector<std::string> break_word(const std::string &word,
+                                        std::size_t        max_line_width) const;
+
+    inline std::uint64_t patterns_hash() const {
+        return this->mPatternsHash;
+    }
+};
+} // namespace tema
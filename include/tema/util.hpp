@@ -15,7 +15,34 @@
 
 #pragma once
 
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+// Defined by CMake from the project version
+#ifndef TEMA_VERSION
+#define TEMA_VERSION "unknown"
+#endif
+
 namespace tema {
+inline constexpr std::string_view VERSION = TEMA_VERSION;
+
+// 64-bit FNV-1a
+inline std::uint64_t hash_content(std::string_view content) {
+    std::uint64_t hash = 0xcbf29ce484222325;
+
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
 template <typename T> class Singleton {
     protected:
     Singleton() = default;
@@ -29,4 +56,98 @@ template <typename T> class Singleton {
         return instance;
     }
 };
+
+// Minimal lazy sequence backed by a coroutine. Values are produced with
+// co_yield only when the consumer advances the iterator
+template <typename T> class Generator {
+    public:
+    struct promise_type {
+        std::optional<T>   mValue;
+        std::exception_ptr mException;
+
+        Generator get_return_object() {
+            return Generator(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_always yield_value(T value) {
+            this->mValue = std::move(value);
+            return {};
+        }
+
+        void return_void() {
+        }
+
+        void unhandled_exception() {
+            this->mException = std::current_exception();
+        }
+    };
+
+    class Iterator {
+        private:
+        std::coroutine_handle<promise_type> mHandle;
+
+        public:
+        Iterator(std::coroutine_handle<promise_type> handle)
+            : mHandle(handle) {};
+
+        T &operator*() const {
+            return *this->mHandle.promise().mValue;
+        }
+
+        Iterator &operator++() {
+            this->resume();
+            return *this;
+        }
+
+        bool operator==(std::default_sentinel_t) const {
+            return !this->mHandle || this->mHandle.done();
+        }
+
+        void resume() {
+            this->mHandle.resume();
+
+            if (this->mHandle.promise().mException) {
+                std::rethrow_exception(this->mHandle.promise().mException);
+            }
+        }
+    };
+
+    private:
+    std::coroutine_handle<promise_type> mHandle;
+
+    public:
+    explicit Generator(std::coroutine_handle<promise_type> handle)
+        : mHandle(handle) {};
+
+    Generator(Generator &&other) noexcept
+        : mHandle(std::exchange(other.mHandle, nullptr)) {};
+
+    Generator(const Generator &)            = delete;
+    Generator &operator=(const Generator &) = delete;
+
+    ~Generator() {
+        if (this->mHandle) {
+            this->mHandle.destroy();
+        }
+    }
+
+    Iterator begin() {
+        Iterator it(this->mHandle);
+        it.resume();
+        return it;
+    }
+
+    std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+};
 } // namespace tema
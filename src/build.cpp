@@ -0,0 +1,393 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <louvre/api.hpp>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tema/build.hpp>
+#include <tema/emit.hpp>
+#include <tema/hyphenate.hpp>
+#include <tema/util.hpp>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace tema {
+static constexpr const char *MANIFEST_NAME   = ".tema-manifest";
+static constexpr const char *MANIFEST_HEADER = "tema-manifest 1";
+
+static std::optional<std::string> read_file(const std::filesystem::path &path) {
+    std::ifstream input(path, std::ios::binary);
+
+    if (!input.is_open()) {
+        return std::nullopt;
+    }
+
+    std::size_t file_size = std::filesystem::file_size(path);
+    std::string content(file_size, '\0');
+    input.read(content.data(), file_size);
+    return content;
+}
+
+// Whether path lies strictly below dir, both being canonical
+static bool is_inside(const std::filesystem::path &path,
+                      const std::filesystem::path &dir) {
+    std::filesystem::path relative = path.lexically_relative(dir);
+    return !relative.empty() && "." != relative && ".." != *relative.begin();
+}
+
+bool Manifest::load(const std::filesystem::path &path) {
+    std::ifstream input(path);
+
+    if (!input.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(input, line) || MANIFEST_HEADER != line) {
+        return false;
+    }
+
+    // Each line is: <hash>\t<version>\t<options>\t<source>
+    while (std::getline(input, line)) {
+        std::stringstream stream(line);
+        std::string       hash;
+        ManifestEntry     entry;
+        std::string       source;
+
+        if (!std::getline(stream, hash, '\t') ||
+            !std::getline(stream, entry.version, '\t') ||
+            !std::getline(stream, entry.options, '\t') ||
+            !std::getline(stream, source) || source.empty()) {
+            continue;
+        }
+
+        // A damaged entry only makes its output stale
+        auto [end, err] = std::from_chars(
+            hash.data(), hash.data() + hash.size(), entry.source_hash, 16);
+
+        if (std::errc() != err || hash.data() + hash.size() != end) {
+            continue;
+        }
+
+        // Sources are joined onto the output directory when their outputs
+        // are removed, so an entry must never point outside of it
+        std::filesystem::path normal =
+            std::filesystem::path(source).lexically_normal();
+
+        if (normal.has_root_path() || normal.empty() ||
+            ".." == *normal.begin()) {
+            continue;
+        }
+
+        this->mEntries.insert_or_assign(source, entry);
+    }
+
+    return true;
+}
+
+bool Manifest::save(const std::filesystem::path &path) const {
+    // Write to a temporary file first so that an interrupted build never
+    // leaves a truncated manifest behind
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+
+    {
+        std::ofstream output(tmp_path, std::ios::trunc);
+
+        if (!output.is_open()) {
+            return false;
+        }
+
+        output << MANIFEST_HEADER << '\n';
+        for (const auto &[source, entry] : this->mEntries) {
+            output << std::hex << entry.source_hash << std::dec << '\t'
+                   << entry.version << '\t' << entry.options << '\t' << source
+                   << '\n';
+        }
+
+        if (!output.good()) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    return !ec;
+}
+
+std::optional<ManifestEntry> Manifest::find(const std::string &source) const {
+    auto it = this->mEntries.find(source);
+
+    if (this->mEntries.end() == it) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
+
+void Manifest::set(const std::string &source, ManifestEntry entry) {
+    this->mEntries.insert_or_assign(source, entry);
+}
+
+BuildStats Builder::build() {
+    BuildStats stats;
+    Manifest   old_manifest;
+    Manifest   new_manifest;
+
+    std::error_code ec;
+
+    if (!std::filesystem::is_directory(this->source_dir(), ec)) {
+        std::cerr << "ERROR: Source is not a directory: " << this->source_dir()
+                  << std::endl;
+        stats.failed++;
+        return stats;
+    }
+
+    // Outputs would otherwise be mixed with (and mistaken for) sources
+    std::error_code source_ec;
+    std::error_code output_ec;
+
+    if (std::filesystem::weakly_canonical(this->source_dir(), source_ec) ==
+            std::filesystem::weakly_canonical(this->output_dir(), output_ec) &&
+        !source_ec && !output_ec) {
+        std::cerr << "ERROR: Output directory must differ from source "
+                     "directory"
+                  << std::endl;
+        stats.failed++;
+        return stats;
+    }
+
+    if (!std::filesystem::create_directories(this->output_dir(), ec) && ec) {
+        std::cerr << "ERROR: Could not create output directory: "
+                  << this->output_dir() << ": " << ec.message() << std::endl;
+        stats.failed++;
+        return stats;
+    }
+
+    old_manifest.load(this->manifest_path());
+
+    // Collect sources, skipping the output directory in case it lives
+    // inside the source tree
+    std::filesystem::path output_dir =
+        std::filesystem::weakly_canonical(this->output_dir(), ec);
+    std::vector<std::string> sources;
+
+    auto it = std::filesystem::recursive_directory_iterator(
+        this->source_dir(),
+        std::filesystem::directory_options::skip_permission_denied,
+        ec);
+
+    for (; !ec && std::filesystem::recursive_directory_iterator() != it;
+         it.increment(ec)) {
+        std::error_code entry_ec;
+
+        if (it->is_directory(entry_ec) &&
+            output_dir ==
+                std::filesystem::weakly_canonical(it->path(), entry_ec)) {
+            it.disable_recursion_pending();
+            continue;
+        }
+
+        if (it->is_regular_file(entry_ec) && this->is_source(it->path())) {
+            sources.push_back(
+                it->path().lexically_relative(this->source_dir()).generic_string());
+        }
+    }
+
+    // An incomplete walk would make existing outputs look orphaned
+    if (ec) {
+        std::cerr << "ERROR: Could not read source directory: "
+                  << this->source_dir() << ": " << ec.message() << std::endl;
+        stats.failed++;
+        return stats;
+    }
+
+    std::string              options = this->options();
+    std::string              version(VERSION);
+    std::atomic<std::size_t> next_source = 0;
+    std::mutex               lock;
+
+    auto worker = [&]() {
+        for (std::size_t i = next_source++; i < sources.size();
+             i = next_source++) {
+            const std::string &source = sources.at(i);
+
+            try {
+                auto content = read_file(this->source_dir() / source);
+
+                if (!content) {
+                    std::cerr << "ERROR: Could not open file: " + source + "\n";
+                    std::lock_guard guard(lock);
+                    stats.failed++;
+                    continue;
+                }
+
+                ManifestEntry entry{hash_content(*content), options, version};
+                auto          old_entry = old_manifest.find(source);
+
+                if (old_entry && old_entry->source_hash == entry.source_hash &&
+                    old_entry->options == entry.options &&
+                    old_entry->version == entry.version &&
+                    std::filesystem::exists(this->output_path(source))) {
+                    std::lock_guard guard(lock);
+                    new_manifest.set(source, entry);
+                    stats.fresh++;
+                    continue;
+                }
+
+                if (this->render(source, *content)) {
+                    std::lock_guard guard(lock);
+                    new_manifest.set(source, entry);
+                    stats.rendered++;
+                    continue;
+                }
+            } catch (const std::exception &e) {
+                // Anything escaping the thread would terminate the whole build
+                // before the manifest is written
+                std::cerr << "ERROR: " + source + ": " + e.what() + "\n";
+            }
+
+            // Leaving the entry out of the manifest forces a retry next time
+            std::error_code ec;
+            std::filesystem::remove(this->output_path(source), ec);
+            std::lock_guard guard(lock);
+            stats.failed++;
+        }
+    };
+
+    std::size_t num_workers =
+        std::clamp<std::size_t>(std::thread::hardware_concurrency(),
+                                1,
+                                std::max<std::size_t>(sources.size(), 1));
+    std::vector<std::thread> workers;
+
+    for (std::size_t i = 0; i < num_workers; i++) {
+        workers.emplace_back(worker);
+    }
+
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    // Remove outputs whose sources are gone
+    std::unordered_set<std::string> source_set(sources.begin(), sources.end());
+
+    for (const auto &[source, entry] : old_manifest.entries()) {
+        if (source_set.contains(source)) {
+            continue;
+        }
+
+        std::filesystem::path out = this->output_path(source);
+        ec.clear();
+
+        if (std::filesystem::remove(out, ec)) {
+            stats.removed++;
+        }
+
+        // Prune directories left empty by the removal, stopping at the
+        // output directory
+        for (auto dir =
+                 std::filesystem::weakly_canonical(out.parent_path(), ec);
+             !ec && is_inside(dir, output_dir) &&
+             std::filesystem::is_empty(dir, ec);
+             dir = dir.parent_path()) {
+            std::filesystem::remove(dir, ec);
+        }
+    }
+
+    if (!new_manifest.save(this->manifest_path())) {
+        std::cerr << "ERROR: Could not write manifest" << std::endl;
+        stats.failed++;
+    }
+
+    return stats;
+}
+
+std::string Builder::options() const {
+    std::stringstream stream;
+    stream << this->mMaxLineWidth << ',' << this->mBorderWidth << ','
+           << this->mIndentWidth << ',' << std::hex;
+
+    // The EOL may contain control characters, so it is stored as hex
+    for (unsigned char c : EmitterSettings::get_instance().eol()) {
+        stream << std::setw(2) << std::setfill('0')
+               << static_cast<unsigned>(c);
+    }
+
+    // Hyphenation changes where over-long words break
+    stream << ',' << EmitterSettings::get_instance().hyphenate() << ','
+           << Hyphenator::get_instance().patterns_hash();
+
+    return stream.str();
+}
+
+bool Builder::is_source(const std::filesystem::path &path) const {
+    return this->extension() == path.extension() &&
+           MANIFEST_NAME != path.filename();
+}
+
+std::filesystem::path
+Builder::output_path(const std::string &source) const {
+    // Keep the source extension so that a.lv and a.md never share a.txt
+    std::filesystem::path out = this->output_dir() / source;
+    out += ".txt";
+    return out;
+}
+
+std::filesystem::path Builder::manifest_path() const {
+    return this->output_dir() / MANIFEST_NAME;
+}
+
+bool Builder::render(const std::string &source,
+                     const std::string &content) const {
+    auto parser       = louvre::Parser(content);
+    auto parse_result = parser.parse();
+    auto rootp = std::get_if<std::shared_ptr<louvre::Node>>(&parse_result);
+
+    if (!rootp) {
+        std::cerr << "ERROR: Could not parse file: " + source + "\n";
+        return false;
+    }
+
+    Emitter     emitter(
+        this->mMaxLineWidth, this->mBorderWidth, this->mIndentWidth);
+    std::string out = emitter.emit(*rootp);
+
+    std::filesystem::path out_path = this->output_path(source);
+    std::filesystem::create_directories(out_path.parent_path());
+    std::ofstream output(out_path, std::ios::binary | std::ios::trunc);
+
+    if (!output.is_open()) {
+        std::cerr << "ERROR: Could not write file: " + out_path.string() + "\n";
+        return false;
+    }
+
+    output << out;
+    return output.good();
+}
+} // namespace tema
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <iostream>
 #include <louvre/api.hpp>
+#include <optional>
 #include <string>
 #include <tema/emit.hpp>
 #include <tema/format.hpp>
@@ -33,18 +34,75 @@ std::string Emitter::emit(std::shared_ptr<louvre::Node> root) {
 std::string Emitter::emit_recurisve(std::shared_ptr<louvre::Node> root,
                                     std::size_t                   avail_width,
                                     Formatter                    &formatter) {
-    std::size_t indent              = 0;
-    std::size_t indent_ignore_lines = 0;
-    std::string prefix;
-    Formatter  *children_formatter = &formatter;
+    auto        layout = this->layout(root, formatter);
+    std::string buf;
+
+    if (!layout) {
+        for (auto &fragment : this->emit_leaf(root, avail_width, formatter)) {
+            buf.append(fragment);
+        }
+
+        return buf;
+    }
+
+    for (std::size_t i = 0; i < root->children().size(); i++) {
+        auto child = root->children().at(i);
+
+        // Print leading new line when separating blocks
+        if (0 != i && !child->children().empty()) {
+            buf.append(EmitterSettings::get_instance().eol());
+        }
+
+        std::string child_content = layout->prefix;
+        child_content.append(this->emit_recurisve(
+            child, avail_width - layout->indent, *layout->children_formatter));
+        buf.append(formatter.indent(
+            child_content, layout->indent, layout->indent_ignore_lines));
+
+        // Print trailing new line when separating blcks
+        if (i != root->children().size() - 1 && !child->children().empty()) {
+            buf.append(EmitterSettings::get_instance().eol());
+        }
+    }
+
+    return buf;
+}
+
+Generator<std::string> Emitter::lines(std::shared_ptr<louvre::Node> root) {
+    const std::string eol = EmitterSettings::get_instance().eol();
+    std::string       pending;
+
+    for (auto &fragment : LeftIndenter::get_instance().indent_lazy(
+             this->emit_lazy(root,
+                             this->max_line_width() - this->border_width() * 2,
+                             LeftFormatter::get_instance()),
+             this->border_width())) {
+        pending.append(fragment);
+
+        std::size_t start = 0;
+        for (std::size_t end = pending.find(eol); std::string::npos != end;
+             start = end + eol.length(), end = pending.find(eol, start)) {
+            co_yield pending.substr(start, end - start);
+        }
+
+        pending.erase(0, start);
+    }
+
+    co_yield pending;
+}
+
+std::optional<Layout> Emitter::layout(std::shared_ptr<louvre::Node> root,
+                                      Formatter &formatter) {
+    Layout layout;
+    layout.children_formatter = &formatter;
 
     switch (std::get<louvre::StandardNodeType>(root->type())) {
     case louvre::StandardNodeType::Left:
-        children_formatter = &LeftFormatter::get_instance();
+        layout.children_formatter = &LeftFormatter::get_instance();
         break;
 
     case louvre::StandardNodeType::Center:
-        children_formatter = &CenterFormatter::get_instance();
+        layout.children_formatter = &CenterFormatter::get_instance();
         break;
 
     case louvre::StandardNodeType::Right:
@@ -54,49 +112,88 @@ std::string Emitter::emit_recurisve(std::shared_ptr<louvre::Node> root,
         break;
 
     case louvre::StandardNodeType::LineBreak:
-        return EmitterSettings::get_instance().eol();
-
     case louvre::StandardNodeType::Text:
-        return formatter.format(*root->text(), avail_width);
+        return std::nullopt;
 
     case louvre::StandardNodeType::Paragraph:
     case louvre::StandardNodeType::Bullets:
     case louvre::StandardNodeType::Numebrs:
-        indent = this->indent_width();
+        layout.indent = this->indent_width();
         break;
 
     case louvre::StandardNodeType::Item:
-        prefix              = "-  ";
-        indent              = 3;
-        indent_ignore_lines = 1;
+        layout.prefix              = "-  ";
+        layout.indent              = 3;
+        layout.indent_ignore_lines = 1;
         break;
 
     default:
         break;
     }
 
-    std::string buf;
+    return layout;
+}
+
+Generator<std::string> Emitter::emit_leaf(std::shared_ptr<louvre::Node> root,
+                                          std::size_t avail_width,
+                                          Formatter  &formatter) {
+    if (louvre::StandardNodeType::LineBreak ==
+        std::get<louvre::StandardNodeType>(root->type())) {
+        co_yield EmitterSettings::get_instance().eol();
+        co_return;
+    }
+
+    for (auto &fragment : formatter.format_lazy(*root->text(), avail_width)) {
+        co_yield std::move(fragment);
+    }
+}
+
+static Generator<std::string> prepend(std::string            prefix,
+                                      Generator<std::string> text) {
+    if (!prefix.empty()) {
+        co_yield std::move(prefix);
+    }
+
+    for (auto &fragment : text) {
+        co_yield std::move(fragment);
+    }
+}
+
+Generator<std::string> Emitter::emit_lazy(std::shared_ptr<louvre::Node> root,
+                                          std::size_t avail_width,
+                                          Formatter  &formatter) {
+    auto layout = this->layout(root, formatter);
+
+    if (!layout) {
+        for (auto &fragment : this->emit_leaf(root, avail_width, formatter)) {
+            co_yield std::move(fragment);
+        }
+
+        co_return;
+    }
+
     for (std::size_t i = 0; i < root->children().size(); i++) {
         auto child = root->children().at(i);
 
-        // Print leading new line when separating blocks
+        // Same block separation rules as emit_recurisve
         if (0 != i && !child->children().empty()) {
-            buf.append(EmitterSettings::get_instance().eol());
+            co_yield EmitterSettings::get_instance().eol();
         }
 
-        std::string child_content = prefix;
-        child_content.append(this->emit_recurisve(
-            child, avail_width - indent, *children_formatter));
-        buf.append(
-            formatter.indent(child_content, indent, indent_ignore_lines));
+        for (auto &fragment : formatter.indent_lazy(
+                 prepend(layout->prefix,
+                         this->emit_lazy(child,
+                                         avail_width - layout->indent,
+                                         *layout->children_formatter)),
+                 layout->indent,
+                 layout->indent_ignore_lines)) {
+            co_yield std::move(fragment);
+        }
 
-        // Print trailing new line when separating blcks
         if (i != root->children().size() - 1 && !child->children().empty()) {
-            buf.append(EmitterSettings::get_instance().eol());
+            co_yield EmitterSettings::get_instance().eol();
         }
     }
-
-    return buf;
 }
 
 inline bool Emitter::can_ignore_prev_line_break(
@@ -19,9 +19,11 @@
 #include <string>
 #include <tema/emit.hpp>
 #include <tema/format.hpp>
+#include <tema/hyphenate.hpp>
 #include <tema/split.hpp>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace tema {
 std::pair<std::string, std::size_t>
@@ -47,6 +49,28 @@ Indenter::ignored_before_line(std::stringstream &text_stream,
     return std::make_pair(buf, line_count);
 }
 
+Generator<std::string>
+Indenter::indent_lazy(Generator<std::string> text,
+                      std::size_t            indent_width,
+                      std::size_t            ignore_before_line) {
+    std::string buf;
+
+    for (auto &fragment : text) {
+        buf.append(fragment);
+    }
+
+    co_yield this->indent(buf, indent_width, ignore_before_line);
+}
+
+Generator<std::string>
+NullIndenter::indent_lazy(Generator<std::string> text,
+                          std::size_t            indent_width,
+                          std::size_t            ignore_before_line) {
+    for (auto &fragment : text) {
+        co_yield std::move(fragment);
+    }
+}
+
 std::string LeftIndenter::indent(const std::string text,
                                  std::size_t       indent_width,
                                  std::size_t       ignore_before_line) {
@@ -82,6 +106,62 @@ std::string LeftIndenter::indent(const std::string text,
     return buf;
 }
 
+Generator<std::string>
+LeftIndenter::indent_lazy(Generator<std::string> text,
+                          std::size_t            indent_width,
+                          std::size_t            ignore_before_line) {
+    if (0 == indent_width) {
+        for (auto &fragment : text) {
+            co_yield std::move(fragment);
+        }
+
+        co_return;
+    }
+
+    std::string spaces(indent_width, ' ');
+    std::size_t line_index = 0;
+    bool        line_start = true;
+    bool        line_ended = false;
+
+    // Works character by character, so every fragment is indented as soon
+    // as it arrives
+    for (auto &fragment : text) {
+        std::string buf;
+
+        for (char c : fragment) {
+            // Like std::getline in indent, a trailing new line does not
+            // start a new line, so its EOL is only emitted once more text
+            // follows
+            if (line_ended) {
+                buf.append(EmitterSettings::get_instance().eol());
+                line_index++;
+                line_start = true;
+                line_ended = false;
+            }
+
+            if ('\n' == c) {
+                if (line_start && 0 == line_index && 0 == ignore_before_line) {
+                    buf.append(EmitterSettings::get_instance().eol());
+                }
+
+                line_ended = true;
+                continue;
+            }
+
+            if (line_start && line_index >= ignore_before_line) {
+                buf.append(spaces);
+            }
+
+            line_start = false;
+            buf.push_back(c);
+        }
+
+        if (!buf.empty()) {
+            co_yield std::move(buf);
+        }
+    }
+}
+
 std::string RightIndenter::indent(const std::string text,
                                   std::size_t       indent_width,
                                   std::size_t       ignore_before_line) {
@@ -127,8 +207,49 @@ std::string RightIndenter::indent(const std::string text,
     return buf;
 }
 
+std::vector<std::string>
+Formatter::break_word(const std::string &word,
+                      std::size_t        max_line_width) const {
+    if (!EmitterSettings::get_instance().hyphenate()) {
+        return {word};
+    }
+
+    return Hyphenator::get_instance().break_word(word, max_line_width);
+}
+
+static std::string center_line(const std::string &line,
+                               std::size_t        max_line_width) {
+    // Lines may exceed the width (e.g., unbroken long words)
+    std::size_t edges =
+        (max_line_width > line.length()) ? max_line_width - line.length() : 0;
+    std::string buf(edges / 2, ' ');
+    buf.append(line);
+    return buf;
+}
+
+Generator<std::string> Formatter::format_lazy(const std::string text,
+                                              std::size_t max_line_width) {
+    co_yield this->format(text, max_line_width);
+}
+
+static std::string join(Generator<std::string> fragments) {
+    std::string buf;
+
+    for (auto &fragment : fragments) {
+        buf.append(fragment);
+    }
+
+    return buf;
+}
+
 std::string LeftFormatter::format(const std::string text,
                                   std::size_t       max_line_width) {
+    return join(this->format_lazy(text, max_line_width));
+}
+
+Generator<std::string>
+LeftFormatter::format_lazy(const std::string text,
+                           std::size_t       max_line_width) {
     auto        splitter = Splitter(text);
     std::size_t carry    = 0;
     std::string buf;
@@ -140,16 +261,40 @@ std::string LeftFormatter::format(const std::string text,
             break;
         }
 
-        std::string word = *word_opt;
-        long        rem  = max_line_width - start_pos - word.length();
+        std::string word     = *word_opt;
+        long        rem      = max_line_width - start_pos - word.length();
+        bool        new_line = false;
+
+        std::vector<std::string> pieces;
+
+        // Words longer than the line start on a new one and take up as
+        // many lines as needed
+        if (word.length() > max_line_width) {
+            pieces = this->break_word(word, max_line_width);
+        }
 
-        // TODO: Handle case in which word is longer than line
+        if (pieces.size() > 1) {
+            if (0 != start_pos + carry) {
+                buf.append(EmitterSettings::get_instance().eol());
+            }
 
-        if (start_pos + carry + word.length() > max_line_width) {
+            for (std::size_t i = 0; i < pieces.size() - 1; i++) {
+                buf.append(pieces.at(i));
+                buf.append(EmitterSettings::get_instance().eol());
+            }
+
+            word = pieces.back();
+            splitter.reset_line();
+            carry    = word.length() + 1;
+            rem      = max_line_width - word.length();
+            new_line = true;
+        } else if (0 != start_pos + carry &&
+                   start_pos + carry + word.length() > max_line_width) {
             buf.append(EmitterSettings::get_instance().eol());
             splitter.reset_line();
-            carry = word.length() + 1;
-            rem   = max_line_width - word.length();
+            carry    = word.length() + 1;
+            rem      = max_line_width - word.length();
+            new_line = true;
         }
 
         buf.append(word);
@@ -157,42 +302,71 @@ std::string LeftFormatter::format(const std::string text,
         if (rem >= 1) {
             buf.push_back(' ');
         }
+
+        // Hand over finished lines together with the start of the next one,
+        // so that consumers know the EOL is not trailing
+        if (new_line) {
+            co_yield std::move(buf);
+            buf.clear();
+        }
     }
 
-    return buf;
+    if (!buf.empty()) {
+        co_yield std::move(buf);
+    }
 }
 
 std::string CenterFormatter::format(const std::string text,
                                     std::size_t       max_line_width) {
+    return join(this->format_lazy(text, max_line_width));
+}
+
+Generator<std::string>
+CenterFormatter::format_lazy(const std::string text,
+                             std::size_t       max_line_width) {
     auto        splitter = Splitter(text);
-    std::string buf;
-    std::size_t carry = 0;
+    std::size_t carry    = 0;
     std::string line;
 
     while (true) {
         auto [start_pos, word_opt] = splitter.next_word();
 
         if (!word_opt) {
-            std::size_t edges = max_line_width - line.length();
-            std::size_t left  = edges / 2;
-
-            buf.append(std::string(left, ' '));
-            buf.append(line);
+            co_yield center_line(line, max_line_width);
             break;
         }
 
         std::string word = *word_opt;
         std::size_t rem  = max_line_width - start_pos - word.length();
 
-        // TODO: Handle case in which word is longer than line
+        std::vector<std::string> pieces;
 
-        if (start_pos + carry + word.length() > max_line_width) {
-            std::size_t edges = max_line_width - line.length();
-            std::size_t left  = edges / 2;
+        // Words longer than the line start on a new one and take up as
+        // many lines as needed
+        if (word.length() > max_line_width) {
+            pieces = this->break_word(word, max_line_width);
+        }
 
-            buf.append(std::string(left, ' '));
-            buf.append(line);
-            buf.append(EmitterSettings::get_instance().eol());
+        if (pieces.size() > 1) {
+            if (!line.empty()) {
+                co_yield center_line(line, max_line_width) +
+                    EmitterSettings::get_instance().eol();
+                line.clear();
+            }
+
+            for (std::size_t i = 0; i < pieces.size() - 1; i++) {
+                co_yield center_line(pieces.at(i), max_line_width) +
+                    EmitterSettings::get_instance().eol();
+            }
+
+            word = pieces.back();
+            splitter.reset_line();
+            carry = word.length() + 1;
+            rem   = max_line_width - word.length();
+        } else if (!line.empty() &&
+                   start_pos + carry + word.length() > max_line_width) {
+            co_yield center_line(line, max_line_width) +
+                EmitterSettings::get_instance().eol();
             line.clear();
 
             splitter.reset_line();
@@ -206,7 +380,5 @@ std::string CenterFormatter::format(const std::string text,
             line.push_back(' ');
         }
     }
-
-    return buf;
 }
 } // namespace tema
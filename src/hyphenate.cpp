@@ -0,0 +1,314 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tema/hyphenate.hpp>
+#include <tema/util.hpp>
+#include <utility>
+#include <vector>
+
+namespace tema {
+// UTF-8 continuation bytes (10xxxxxx) never start a code point
+static bool is_continuation(unsigned char c) {
+    return 0x80 == (c & 0xC0);
+}
+
+// Moves a cut back to the closest code point boundary after start, or
+// forward past the code point at start if there is none
+static std::size_t
+cut_at_boundary(const std::string &word, std::size_t start, std::size_t end) {
+    while (end > start && is_continuation(word.at(end))) {
+        end--;
+    }
+
+    if (end == start) {
+        end++;
+
+        while (end < word.length() && is_continuation(word.at(end))) {
+            end++;
+        }
+    }
+
+    return end;
+}
+
+void PatternTrie::build(
+    const std::vector<std::pair<std::string, std::vector<std::uint8_t>>>
+        &patterns) {
+    struct Node {
+        std::map<std::uint8_t, std::size_t> children;
+        std::int32_t                        value = -1;
+    };
+
+    this->mCodes.fill(0);
+    this->mCells.clear();
+    this->mValues.clear();
+
+    // Map the bytes that appear in patterns to dense codes so that the
+    // children of a node sit close together in the packed array
+    std::uint8_t next_code = 1;
+    for (const auto &[letters, values] : patterns) {
+        for (unsigned char c : letters) {
+            if (0 == this->mCodes[c]) {
+                this->mCodes[c] = next_code++;
+            }
+        }
+    }
+
+    // Build a plain pointer trie first
+    std::vector<Node> nodes(1);
+    for (const auto &[letters, values] : patterns) {
+        std::size_t node = 0;
+
+        for (unsigned char c : letters) {
+            std::uint8_t code = this->mCodes[c];
+            auto         it   = nodes[node].children.find(code);
+
+            if (nodes[node].children.end() == it) {
+                nodes[node].children.emplace(code, nodes.size());
+                node = nodes.size();
+                nodes.emplace_back();
+            } else {
+                node = it->second;
+            }
+        }
+
+        nodes[node].value = this->mValues.size();
+        this->mValues.insert(this->mValues.end(), values.begin(), values.end());
+    }
+
+    // Pack it breadth-first, placing each set of siblings at the first base
+    // where all of their cells are free. Only bases that put the first
+    // sibling on a free cell are tried
+    this->mCells.resize(1);
+    this->mCells[0].check = -2;
+
+    std::vector<std::pair<std::size_t, std::size_t>> queue = {{0, 0}};
+    std::set<std::size_t>                            free_cells;
+
+    auto is_free = [&](std::size_t cell) {
+        return cell >= this->mCells.size() || -1 == this->mCells[cell].check;
+    };
+
+    for (std::size_t i = 0; i < queue.size(); i++) {
+        auto [node, cell] = queue[i];
+        this->mCells[cell].value = nodes[node].value;
+
+        if (nodes[node].children.empty()) {
+            continue;
+        }
+
+        const auto &children = nodes[node].children;
+        std::size_t min_code = children.begin()->first;
+        std::size_t max_code = children.rbegin()->first;
+        std::size_t base     = 0;
+
+        for (auto it = free_cells.upper_bound(min_code);; it++) {
+            base = (free_cells.end() != it)
+                       ? *it - min_code
+                       : std::max(this->mCells.size(), min_code + 1) - min_code;
+
+            if (std::all_of(children.begin(),
+                            children.end(),
+                            [&](const auto &child) {
+                                return is_free(base + child.first);
+                            })) {
+                break;
+            }
+        }
+
+        for (std::size_t c = this->mCells.size(); c <= base + max_code; c++) {
+            free_cells.insert(c);
+        }
+
+        if (base + max_code >= this->mCells.size()) {
+            this->mCells.resize(base + max_code + 1);
+        }
+
+        this->mCells[cell].base = base;
+        for (const auto &[code, child] : children) {
+            this->mCells[base + code].check = cell;
+            free_cells.erase(base + code);
+            queue.emplace_back(child, base + code);
+        }
+    }
+}
+
+void PatternTrie::apply(const std::string         &text,
+                        std::size_t                start,
+                        std::vector<std::uint8_t> &points) const {
+    if (this->empty()) {
+        return;
+    }
+
+    std::size_t cell = 0;
+
+    for (std::size_t i = start; i < text.length(); i++) {
+        std::uint8_t code =
+            this->mCodes[static_cast<unsigned char>(text.at(i))];
+
+        if (0 == code) {
+            return;
+        }
+
+        std::size_t next = this->mCells[cell].base + code;
+
+        if (next >= this->mCells.size() ||
+            static_cast<std::int32_t>(cell) != this->mCells[next].check) {
+            return;
+        }
+
+        cell = next;
+
+        if (-1 == this->mCells[cell].value) {
+            continue;
+        }
+
+        // A pattern of n letters carries n + 1 values
+        const std::uint8_t *values = &this->mValues[this->mCells[cell].value];
+        for (std::size_t k = 0; k <= i - start + 1; k++) {
+            points[start + k] = std::max(points[start + k], values[k]);
+        }
+    }
+}
+
+bool Hyphenator::load(const std::string &path) {
+    std::ifstream input(path);
+
+    if (!input.is_open()) {
+        return false;
+    }
+
+    this->load(input);
+    return true;
+}
+
+void Hyphenator::load(std::istream &stream) {
+    std::vector<std::pair<std::string, std::vector<std::uint8_t>>> patterns;
+    std::string                                                     all;
+    std::string                                                     line;
+
+    // Accepts plain pattern lists as well as TeX pattern files: comments,
+    // control sequences, braces and hyphenation exceptions are skipped
+    while (std::getline(stream, line)) {
+        line = line.substr(0, line.find('%'));
+        all.append(line);
+        all.push_back('\n');
+
+        std::stringstream tokens(line);
+        std::string       token;
+
+        while (tokens >> token) {
+            if (std::string::npos != token.find_first_of("\\{}-")) {
+                continue;
+            }
+
+            std::string               letters;
+            std::vector<std::uint8_t> values = {0};
+
+            for (unsigned char c : token) {
+                if (std::isdigit(c)) {
+                    values.back() = c - '0';
+                } else {
+                    letters.push_back(std::tolower(c));
+                    values.push_back(0);
+                }
+            }
+
+            if (!letters.empty()) {
+                patterns.emplace_back(letters, values);
+            }
+        }
+    }
+
+    this->mTrie.build(patterns);
+    this->mPatternsHash = hash_content(all);
+}
+
+std::vector<std::size_t>
+Hyphenator::hyphenation_points(const std::string &word) const {
+    std::vector<std::size_t> breaks;
+
+    if (this->mTrie.empty() || word.length() < LEFT_MIN + RIGHT_MIN) {
+        return breaks;
+    }
+
+    std::string text = ".";
+    for (unsigned char c : word) {
+        text.push_back(std::tolower(c));
+    }
+    text.push_back('.');
+
+    std::vector<std::uint8_t> points(text.length() + 1, 0);
+    for (std::size_t i = 0; i < text.length(); i++) {
+        this->mTrie.apply(text, i, points);
+    }
+
+    // points[i + 1] is the value between word[i - 1] and word[i]
+    for (std::size_t i = LEFT_MIN; i <= word.length() - RIGHT_MIN; i++) {
+        if (1 == points[i + 1] % 2 && !is_continuation(word.at(i))) {
+            breaks.push_back(i);
+        }
+    }
+
+    return breaks;
+}
+
+std::vector<std::string>
+Hyphenator::break_word(const std::string &word,
+                       std::size_t        max_line_width) const {
+    if (word.length() <= max_line_width || 0 == max_line_width) {
+        return {word};
+    }
+
+    std::vector<std::size_t> breaks = this->hyphenation_points(word);
+    std::vector<std::string> pieces;
+    std::size_t              start = 0;
+
+    while (word.length() - start > max_line_width) {
+        // Furthest hyphenation point that leaves room for the hyphen
+        auto it = std::upper_bound(
+            breaks.begin(), breaks.end(), start + max_line_width - 1);
+        std::size_t end = (breaks.begin() != it) ? *(it - 1) : start;
+
+        // Hard breaks add no hyphen, so tokens such as URLs stay intact
+        // when copied back together
+        if (end > start) {
+            pieces.push_back(word.substr(start, end - start) + "-");
+        } else {
+            end = cut_at_boundary(word, start, start + max_line_width);
+            pieces.push_back(word.substr(start, end - start));
+        }
+
+        start = end;
+    }
+
+    // A single code point wider than the line may already end the word
+    if (start < word.length()) {
+        pieces.push_back(word.substr(start));
+    }
+
+    return pieces;
+}
+} // namespace tema
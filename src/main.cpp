@@ -13,30 +13,108 @@
  *   limitations under the License.
  */
 
+#include <charconv>
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <louvre/api.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <tema/build.hpp>
 #include <tema/emit.hpp>
+#include <tema/hyphenate.hpp>
 #include <variant>
+#include <vector>
+
+static int build(const char        *source_dir,
+                 const char        *output_dir,
+                 const std::string &extension) {
+    tema::Builder    builder(source_dir, output_dir, extension, 80, 4, 4);
+    tema::BuildStats stats = builder.build();
+
+    std::cout << stats.rendered << " rendered, " << stats.fresh
+              << " up to date, " << stats.removed << " removed, "
+              << stats.failed << " failed" << std::endl;
+    return (0 == stats.failed) ? 0 : -1;
+}
 
 int main(int argc, const char *const argv[]) {
-    if (argc != 2) {
+    std::vector<const char *>  args;
+    std::optional<std::size_t> max_lines;
+    std::string                extension = ".lv";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if ("--max-lines" == arg) {
+            std::string_view number = (i + 1 < argc) ? argv[i + 1] : "";
+            std::size_t      value  = 0;
+            auto [end, err]         = std::from_chars(
+                number.data(), number.data() + number.size(), value);
+
+            if (number.empty() || std::errc() != err ||
+                number.data() + number.size() != end) {
+                std::cerr << "ERROR: --max-lines needs a number" << std::endl;
+                return -1;
+            }
+
+            max_lines = value;
+            i++;
+        } else if ("--patterns" == arg) {
+            if (i + 1 == argc) {
+                std::cerr << "ERROR: --patterns needs a file path" << std::endl;
+                return -1;
+            }
+
+            if (!tema::Hyphenator::get_instance().load(argv[++i])) {
+                std::cerr << "ERROR: Could not open patterns file" << std::endl;
+                return -1;
+            }
+        } else if ("--extension" == arg) {
+            if (i + 1 == argc || '.' != *argv[i + 1]) {
+                std::cerr << "ERROR: --extension needs an extension (e.g., .lv)"
+                          << std::endl;
+                return -1;
+            }
+
+            extension = argv[++i];
+        } else if ("--no-hyphenate" == arg) {
+            tema::EmitterSettings::get_instance().set_hyphenate(false);
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
+    tema::EmitterSettings::get_instance().set_eol("\n");
+
+    if (!args.empty() && std::string("build") == args.front()) {
+        if (args.size() != 3 || max_lines) {
+            std::cerr << "ERROR: Usage: tema build <source dir> <output dir>"
+                      << std::endl;
+            return -1;
+        }
+
+        return build(args.at(1), args.at(2), extension);
+    }
+
+    if (args.size() != 1) {
         std::cerr << "ERROR: Need exactly one argument: file path" << std::endl;
         return -1;
     }
 
-    std::ifstream input(argv[1]);
+    const char *path = args.front();
+
+    std::ifstream input(path);
 
     if (!input.is_open()) {
         std::cerr << "ERROR: Could not open file" << std::endl;
         return -1;
     }
 
-    std::size_t file_size = std::filesystem::file_size(argv[1]);
+    std::size_t file_size = std::filesystem::file_size(path);
     std::string source(file_size, '\0');
     input.read(source.data(), file_size);
 
@@ -51,9 +129,30 @@ int main(int argc, const char *const argv[]) {
     if (auto rootp =
             std::get_if<std::shared_ptr<louvre::Node>>(&parse_result)) {
         auto root = *rootp;
-        tema::EmitterSettings::get_instance().set_eol("\n");
         tema::Emitter emitter(80, 4, 4);
-        std::string   out = emitter.emit(root);
-        std::cout << out;
+
+        if (!max_lines) {
+            std::string out = emitter.emit(root);
+            std::cout << out;
+            return 0;
+        }
+
+        if (0 == *max_lines) {
+            return 0;
+        }
+
+        // Only render as much of the document as needed
+        std::size_t line_count = 0;
+        for (auto &line : emitter.lines(root)) {
+            if (0 != line_count) {
+                std::cout << tema::EmitterSettings::get_instance().eol();
+            }
+
+            std::cout << line;
+
+            if (++line_count == *max_lines) {
+                break;
+            }
+        }
     }
 }
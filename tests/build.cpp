@@ -0,0 +1,217 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tema/build.hpp>
+#include <tema/emit.hpp>
+#include <tema/util.hpp>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #cond             \
+                      << std::endl;                                            \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+static std::filesystem::path root;
+
+static void write_file(const std::filesystem::path &path,
+                       const std::string           &content) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << content;
+}
+
+static tema::BuildStats build(std::size_t max_line_width = 80) {
+    tema::Builder builder(
+        root / "src", root / "out", ".lv", max_line_width, 4, 4);
+    return builder.build();
+}
+
+static void reset() {
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "src");
+}
+
+static void test_manifest_round_trip() {
+    reset();
+
+    tema::Manifest manifest;
+    manifest.set("a.lv", {0x0123456789abcdef, "80,4,4,0a,1,0", "1.2.3"});
+    manifest.set("dir/b c.lv", {0, "", "1.2.3"});
+    CHECK(manifest.save(root / "manifest"));
+
+    tema::Manifest loaded;
+    CHECK(loaded.load(root / "manifest"));
+    CHECK(2 == loaded.entries().size());
+
+    auto a = loaded.find("a.lv");
+    CHECK(a && 0x0123456789abcdef == a->source_hash &&
+          "80,4,4,0a,1,0" == a->options && "1.2.3" == a->version);
+
+    auto b = loaded.find("dir/b c.lv");
+    CHECK(b && 0 == b->source_hash && b->options.empty());
+}
+
+static void test_manifest_damaged_lines() {
+    reset();
+
+    write_file(root / "manifest",
+               "tema-manifest 1\n"
+               "ff\t1.0\topts\tgood.lv\n"
+               "not-hex\t1.0\topts\tbad-hash.lv\n"
+               "ff\t1.0\ttruncated.lv\n"
+               "\n"
+               "ff\t1.0\topts\t\n"
+               "ff\t1.0\topts\t../escape.lv\n"
+               "ff\t1.0\topts\ta/../../escape.lv\n"
+               "ff\t1.0\topts\t/absolute.lv\n"
+               "ff\t1.0\topts\ta/./nested.lv\n");
+
+    tema::Manifest manifest;
+    CHECK(manifest.load(root / "manifest"));
+    CHECK(2 == manifest.entries().size());
+    CHECK(manifest.find("good.lv"));
+    CHECK(manifest.find("a/./nested.lv"));
+
+    write_file(root / "manifest", "tema-manifest 0\nff\t1.0\topts\ta.lv\n");
+    tema::Manifest old_format;
+    CHECK(!old_format.load(root / "manifest"));
+    CHECK(old_format.entries().empty());
+}
+
+static void test_stale_and_fresh() {
+    reset();
+    write_file(root / "src/a.lv", "Hello world\n");
+
+    tema::BuildStats stats = build();
+    CHECK(1 == stats.rendered && 0 == stats.fresh && 0 == stats.failed);
+    CHECK(std::filesystem::exists(root / "out/a.lv.txt"));
+
+    stats = build();
+    CHECK(0 == stats.rendered && 1 == stats.fresh);
+
+    // Source content
+    write_file(root / "src/a.lv", "Hello again\n");
+    stats = build();
+    CHECK(1 == stats.rendered && 0 == stats.fresh);
+
+    // Rendering options
+    stats = build(40);
+    CHECK(1 == stats.rendered && 0 == stats.fresh);
+    stats = build(40);
+    CHECK(0 == stats.rendered && 1 == stats.fresh);
+
+    // Version of the renderer
+    tema::Manifest manifest;
+    CHECK(manifest.load(root / "out/.tema-manifest"));
+    auto entry = manifest.find("a.lv");
+    CHECK(entry);
+    entry->version = std::string(tema::VERSION) + "-old";
+    manifest.set("a.lv", *entry);
+    CHECK(manifest.save(root / "out/.tema-manifest"));
+
+    stats = build(40);
+    CHECK(1 == stats.rendered && 0 == stats.fresh);
+
+    // A missing output is rendered again even if the entry matches
+    std::filesystem::remove(root / "out/a.lv.txt");
+    stats = build(40);
+    CHECK(1 == stats.rendered && 0 == stats.fresh);
+}
+
+static void test_orphans_removed() {
+    reset();
+    write_file(root / "src/keep.lv", "Kept\n");
+    write_file(root / "src/a/b/gone.lv", "Gone\n");
+    write_file(root / "src/a/c/stays.lv", "Stays\n");
+    write_file(root / "outside.lv.txt", "Not an output\n");
+
+    tema::BuildStats stats = build();
+    CHECK(3 == stats.rendered);
+
+    // An entry pointing outside of the output directory is never followed
+    std::ofstream(root / "out/.tema-manifest", std::ios::app)
+        << "0\t0\t0\t../outside.lv\n";
+
+    std::filesystem::remove(root / "src/a/b/gone.lv");
+    stats = build();
+    CHECK(2 == stats.fresh && 1 == stats.removed);
+    CHECK(!std::filesystem::exists(root / "out/a/b"));
+    CHECK(std::filesystem::exists(root / "out/a/c/stays.lv.txt"));
+    CHECK(std::filesystem::exists(root / "outside.lv.txt"));
+
+    std::filesystem::remove_all(root / "src/a");
+    stats = build();
+    CHECK(1 == stats.fresh && 1 == stats.removed);
+    CHECK(!std::filesystem::exists(root / "out/a"));
+    CHECK(std::filesystem::exists(root / "out/keep.lv.txt"));
+
+    // The output directory itself is never pruned
+    std::filesystem::remove(root / "src/keep.lv");
+    stats = build();
+    CHECK(1 == stats.removed);
+    CHECK(std::filesystem::is_directory(root / "out"));
+    CHECK(std::filesystem::exists(root / "out/.tema-manifest"));
+}
+
+static void test_output_inside_source() {
+    reset();
+    write_file(root / "src/a.lv", "Hello world\n");
+
+    // Outputs named like sources must not be picked up on the next build
+    tema::Builder builder(root / "src", root / "src/out", ".lv", 80, 4, 4);
+    write_file(root / "src/out/stale.lv", "Not a source\n");
+
+    tema::BuildStats stats = builder.build();
+    CHECK(1 == stats.rendered && 0 == stats.failed);
+
+    stats = builder.build();
+    CHECK(0 == stats.rendered && 1 == stats.fresh && 0 == stats.removed);
+    CHECK(!std::filesystem::exists(root / "src/out/out"));
+    CHECK(!std::filesystem::exists(root / "src/out/stale.lv.txt"));
+
+    tema::Builder same(root / "src", root / "src/.", ".lv", 80, 4, 4);
+    CHECK(1 == same.build().failed);
+}
+
+int main() {
+    tema::EmitterSettings::get_instance().set_eol("\n");
+    root = std::filesystem::temp_directory_path() /
+           ("tema-build-test-" + std::to_string(std::random_device()()));
+
+    test_manifest_round_trip();
+    test_manifest_damaged_lines();
+    test_stale_and_fresh();
+    test_orphans_removed();
+    test_output_inside_source();
+
+    std::filesystem::remove_all(root);
+
+    if (0 != failures) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <louvre/api.hpp>
+#include <memory>
+#include <string>
+#include <tema/emit.hpp>
+#include <tema/format.hpp>
+#include <tema/util.hpp>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #cond             \
+                      << std::endl;                                            \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+static const char *DOCUMENTS[] = {
+    "Plain text only",
+
+    "#left Some text on the left that is long enough to wrap around # "
+    "#center A centered title #end # "
+    "#paragraph An indented paragraph of text # with a line break "
+    "#paragraph and a nested paragraph inside of it #end #end #end",
+
+    "#center Centered text # "
+    "#paragraph A centered paragraph with words that wrap #end # "
+    "#bullets #item A centered item #end #end #end",
+
+    "#bullets "
+    "#item First item with enough words to wrap over several lines #end "
+    "#item # Item starting with a line break #end "
+    "#item Item with # a line break in the middle #end "
+    "#item #bullets #item Nested item #end #item Another one #end #end #end "
+    "#end",
+
+    "# # Leading line breaks # "
+    "#paragraph # #item An item inside of a paragraph #end #end "
+    "#left Words such as incomprehensibilities are broken # #end",
+};
+
+static std::shared_ptr<louvre::Node> parse(const std::string &source) {
+    auto parser       = louvre::Parser(source);
+    auto parse_result = parser.parse();
+    auto rootp = std::get_if<std::shared_ptr<louvre::Node>>(&parse_result);
+
+    if (!rootp) {
+        std::cerr << "ERROR: Could not parse: " << source << std::endl;
+        failures++;
+        return nullptr;
+    }
+
+    return *rootp;
+}
+
+static std::string join_lines(tema::Emitter                &emitter,
+                              std::shared_ptr<louvre::Node> root) {
+    std::string buf;
+    bool        first = true;
+
+    for (auto &line : emitter.lines(root)) {
+        if (!first) {
+            buf.append(tema::EmitterSettings::get_instance().eol());
+        }
+
+        buf.append(line);
+        first = false;
+    }
+
+    return buf;
+}
+
+static tema::Generator<std::string>
+fragments(std::vector<std::string> pieces) {
+    for (auto &piece : pieces) {
+        co_yield std::move(piece);
+    }
+}
+
+// Splits text into single characters, so that EOLs are cut in half
+static std::vector<std::string> characters(const std::string &text) {
+    std::vector<std::string> pieces;
+
+    for (char c : text) {
+        pieces.emplace_back(1, c);
+    }
+
+    return pieces;
+}
+
+static std::string indent_lazy(const std::vector<std::string> &pieces,
+                               std::size_t                     indent_width,
+                               std::size_t ignore_before_line) {
+    std::string buf;
+
+    for (auto &fragment : tema::LeftIndenter::get_instance().indent_lazy(
+             fragments(pieces), indent_width, ignore_before_line)) {
+        buf.append(fragment);
+    }
+
+    return buf;
+}
+
+static void test_lines_match_emit() {
+    for (const char *eol : {"\n", "\r\n"}) {
+        tema::EmitterSettings::get_instance().set_eol(eol);
+
+        for (const char *document : DOCUMENTS) {
+            auto root = parse(document);
+
+            if (!root) {
+                continue;
+            }
+
+            for (std::size_t width : {16, 24, 40, 80}) {
+                tema::Emitter emitter(width, 4, 4);
+                CHECK(emitter.emit(root) == join_lines(emitter, root));
+            }
+        }
+    }
+}
+
+static void test_left_indenter_lazy() {
+    tema::LeftIndenter &indenter = tema::LeftIndenter::get_instance();
+
+    const char *texts[] = {
+        "one",
+        "one\ntwo\nthree",
+        "one\ntwo\n",
+        "\none\ntwo",
+        "\n\none\n\ntwo\n\n",
+        "-  item\nsecond line\nthird line",
+        "one\r\ntwo\r\n",
+    };
+
+    for (const char *eol : {"\n", "\r\n"}) {
+        tema::EmitterSettings::get_instance().set_eol(eol);
+
+        for (const char *text : texts) {
+            for (std::size_t ignore_before_line : {0, 1, 2}) {
+                std::string expected =
+                    indenter.indent(text, 3, ignore_before_line);
+
+                CHECK(expected == indent_lazy({text}, 3, ignore_before_line));
+                CHECK(expected ==
+                      indent_lazy(characters(text), 3, ignore_before_line));
+            }
+        }
+    }
+}
+
+static void test_lines_are_lazy() {
+    tema::EmitterSettings::get_instance().set_eol("\n");
+
+    auto root = parse("#left First # Second # incomprehensibilities #end");
+
+    if (!root) {
+        return;
+    }
+
+    // Text formatted after the first line is pulled no longer sees the
+    // hyphenation setting that was active before, so the long word is only
+    // left whole if its text node was not formatted up front
+    tema::Emitter emitter(16, 2, 4);
+    auto          lines = emitter.lines(root);
+    auto          it    = lines.begin();
+
+    CHECK(lines.end() != it && std::string::npos != (*it).find("First"));
+    tema::EmitterSettings::get_instance().set_hyphenate(false);
+
+    std::string rest;
+    for (++it; lines.end() != it; ++it) {
+        rest.append(*it);
+    }
+
+    CHECK(std::string::npos != rest.find("incomprehensibilities"));
+    tema::EmitterSettings::get_instance().set_hyphenate(true);
+}
+
+int main() {
+    test_lines_match_emit();
+    test_left_indenter_lazy();
+    test_lines_are_lazy();
+
+    if (0 != failures) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
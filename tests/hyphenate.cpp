@@ -0,0 +1,203 @@
+/* Copyright 2025 Alessandro Salerno
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tema/emit.hpp>
+#include <tema/format.hpp>
+#include <tema/hyphenate.hpp>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #cond             \
+                      << std::endl;                                            \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+// Patterns from Liang's thesis, enough for "hyphenation"
+static const char *LIANG_PATTERNS =
+    ".hy3ph he2n hena4 hen5at 1na n2at 1tio 2io o2n";
+
+static void load_patterns(const std::string &patterns) {
+    std::stringstream stream(patterns);
+    tema::Hyphenator::get_instance().load(stream);
+}
+
+// Reference implementation: try every substring against a map
+static std::vector<std::size_t>
+naive_points(const std::map<std::string, std::vector<std::uint8_t>> &patterns,
+             const std::string                                      &word) {
+    std::string               text = "." + word + ".";
+    std::vector<std::uint8_t> points(text.length() + 1, 0);
+
+    for (std::size_t i = 0; i < text.length(); i++) {
+        for (std::size_t j = i + 1; j <= text.length(); j++) {
+            auto it = patterns.find(text.substr(i, j - i));
+
+            if (patterns.end() == it) {
+                continue;
+            }
+
+            for (std::size_t k = 0; k < it->second.size(); k++) {
+                points[i + k] = std::max(points[i + k], it->second[k]);
+            }
+        }
+    }
+
+    std::vector<std::size_t> breaks;
+    for (std::size_t i = 2; i + 3 <= word.length(); i++) {
+        if (1 == points[i + 1] % 2) {
+            breaks.push_back(i);
+        }
+    }
+
+    return breaks;
+}
+
+static void test_trie_matches_naive() {
+    std::mt19937                                     rng(1);
+    std::map<std::string, std::vector<std::uint8_t>> patterns;
+    std::string                                      source;
+
+    for (int i = 0; i < 5000; i++) {
+        std::string               token = (0 == rng() % 10) ? "." : "";
+        std::string               letters;
+        std::vector<std::uint8_t> values = {0};
+
+        for (int n = 1 + rng() % 6; n > 0; n--) {
+            if (0 == rng() % 3) {
+                values.back() = rng() % 6;
+                token.push_back('0' + values.back());
+            }
+
+            char c = 'a' + rng() % 26;
+            token.push_back(c);
+            letters.push_back(c);
+            values.push_back(0);
+        }
+
+        if (!token.empty() && '.' == token.front()) {
+            letters.insert(letters.begin(), '.');
+            values.insert(values.begin(), 0);
+        }
+
+        patterns[letters] = values;
+        source.append(token);
+        source.push_back(' ');
+    }
+
+    load_patterns(source);
+
+    for (int i = 0; i < 2000; i++) {
+        std::string word;
+
+        for (int n = 5 + rng() % 15; n > 0; n--) {
+            word.push_back('a' + rng() % 26);
+        }
+
+        CHECK(naive_points(patterns, word) ==
+              tema::Hyphenator::get_instance().hyphenation_points(word));
+    }
+}
+
+static void test_liang_example() {
+    load_patterns(LIANG_PATTERNS);
+
+    auto &hyphenator = tema::Hyphenator::get_instance();
+    CHECK((std::vector<std::size_t>{2, 6}) ==
+          hyphenator.hyphenation_points("hyphenation"));
+    CHECK((std::vector<std::string>{"hyphen-", "ation"}) ==
+          hyphenator.break_word("hyphenation", 8));
+}
+
+static void test_break_word_narrow() {
+    load_patterns(LIANG_PATTERNS);
+
+    auto &hyphenator = tema::Hyphenator::get_instance();
+    CHECK((std::vector<std::string>{"a", "b", "c"}) ==
+          hyphenator.break_word("abc", 1));
+    CHECK((std::vector<std::string>{"hy", "ph", "en", "at", "io", "n"}) ==
+          hyphenator.break_word("hyphenation", 2));
+    CHECK((std::vector<std::string>{"a", "\xc3\xa9", "\xc3\xa9"}) ==
+          hyphenator.break_word("a\xc3\xa9\xc3\xa9", 1));
+}
+
+static void test_center_long_word_without_hyphenation() {
+    tema::EmitterSettings::get_instance().set_eol("\n");
+    tema::EmitterSettings::get_instance().set_hyphenate(false);
+
+    // The long word overflows the line instead of underflowing the padding
+    tema::Formatter &formatter = tema::CenterFormatter::get_instance();
+    CHECK("averyverylongword " == formatter.format("averyverylongword", 5));
+    CHECK("tiny \naveryverylongword \n x " ==
+          formatter.format("tiny averyverylongword x", 5));
+
+    tema::EmitterSettings::get_instance().set_hyphenate(true);
+}
+
+static void test_formatters_hyphenate() {
+    tema::EmitterSettings::get_instance().set_eol("\n");
+    tema::EmitterSettings::get_instance().set_hyphenate(true);
+    load_patterns(LIANG_PATTERNS);
+
+    // The long word starts a new line, is broken at "hyphen-ation" and its
+    // last piece shares a line with the next word
+    tema::Formatter &left = tema::LeftFormatter::get_instance();
+    CHECK("tiny \nhyphen-\nation x " == left.format("tiny hyphenation x", 8));
+    CHECK("tiny \nhy-\nphen-\nation\nx " ==
+          left.format("tiny hyphenation x", 5));
+
+    tema::Formatter &center = tema::CenterFormatter::get_instance();
+    CHECK(" tiny \nhyphen-\nation x " ==
+          center.format("tiny hyphenation x", 8));
+    CHECK("tiny \n hy-\nphen-\nation\n x " ==
+          center.format("tiny hyphenation x", 5));
+
+    // Every piece fits the line
+    for (tema::Formatter *formatter : {&left, &center}) {
+        std::stringstream stream(formatter->format("tiny hyphenation x", 5));
+        std::string       line;
+
+        while (std::getline(stream, line)) {
+            CHECK(line.length() <= 5);
+        }
+    }
+}
+
+int main() {
+    test_trie_matches_naive();
+    test_liang_example();
+    test_break_word_narrow();
+    test_center_long_word_without_hyphenation();
+    test_formatters_hyphenate();
+
+    if (0 != failures) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}